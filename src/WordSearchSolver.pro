@@ -2,7 +2,7 @@
 # Automatically generated by qmake (3.0) Sun Feb 28 16:53:49 2016
 ######################################################################
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 TEMPLATE = app
 TARGET = WordSearchSolver
 INCLUDEPATH += .
@@ -11,10 +11,21 @@ LIBS += -ltesseract -llept
 
 # Input
 HEADERS += mainwindow.h \
-    wordsearch/wordsearch.h
+    wordsearch/wordsearch.h \
+    wordsearch/puzzle.h \
+    wordsearch/solver.h \
+    wordsearch/directionkernel.h \
+    wordsearch/pagereader.h \
+    wordsearch/answerkeyrenderer.h \
+    wordsearch/generator.h
 
 SOURCES += main.cpp mainwindow.cpp \
-    wordsearch/wordsearch.cpp
+    wordsearch/wordsearch.cpp \
+    wordsearch/puzzle.cpp \
+    wordsearch/solver.cpp \
+    wordsearch/pagereader.cpp \
+    wordsearch/answerkeyrenderer.cpp \
+    wordsearch/generator.cpp
 
 RESOURCES += \
     wordsearch.qrc
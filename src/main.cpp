@@ -1,9 +1,146 @@
 #include "mainwindow.h"
+#include "wordsearch/generator.h"
+#include "wordsearch/answerkeyrenderer.h"
 #include <QApplication>
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDir>
+#include <QTextStream>
+
+// writes generated puzzles as .wss files instead of opening the window
+static int generatePuzzles(const QCommandLineParser &parser)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QFile wordFile(parser.value("generate"));
+    if (!wordFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        err << QObject::tr("Cannot read file %1:\n%2\n").arg(wordFile.fileName()).arg(wordFile.errorString());
+        return 1;
+    }
+
+    // one word per line, cleaned up the same way as words typed into the window
+    QStringList words;
+    QTextStream in(&wordFile);
+    for (QString word = in.readLine(); !word.isNull(); word = in.readLine())
+    {
+        word = word.toUpper();
+        word = word.simplified();
+        word.replace(" ", "");
+        if (!word.isEmpty())
+            words << word;
+    }
+
+    const QStringList size = parser.value("size").split('x');
+    const int columns = size.value(0).toInt();
+    const int rows = size.value(1).toInt();
+    const int count = parser.value("count").toInt();
+    if (columns <= 0 || rows <= 0 || count <= 0)
+    {
+        err << QObject::tr("The size must look like 15x15 and the count must be above 0\n");
+        return 1;
+    }
+
+    const quint32 seed = parser.isSet("seed") ? parser.value("seed").toUInt()
+                                              : quint32(QDateTime::currentMSecsSinceEpoch());
+
+    QString problem;
+    if (!Generator::checkWords(words, columns, rows, &problem))
+    {
+        err << QObject::tr("Cannot generate puzzles from %1: %2\n").arg(wordFile.fileName()).arg(problem);
+        return 1;
+    }
+
+    QDir directory(parser.value("output"));
+    if (!directory.mkpath("."))
+    {
+        err << QObject::tr("Cannot create directory %1\n").arg(directory.path());
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const QList<Puzzle> puzzles = Generator::generateMany(words, columns, rows, count, seed);
+    const qint64 elapsed = timer.elapsed();
+
+    for (int i = 0; i != puzzles.size(); ++i)
+    {
+        QFile file(directory.filePath(QString("puzzle%1.wss").arg(i + 1, 4, 10, QChar('0'))));
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            err << QObject::tr("Cannot write file %1:\n%2\n").arg(file.fileName()).arg(file.errorString());
+            return 1;
+        }
+
+        if (!puzzles[i].write(&file) || !file.flush())
+        {
+            err << QObject::tr("Cannot write file %1:\n%2\n").arg(file.fileName()).arg(file.errorString());
+            return 1;
+        }
+    }
+
+    if (parser.isSet("answer-keys"))
+    {
+        const int saved = AnswerKeyRenderer::saveAll(puzzles, directory.path(), "png", AnswerKeyRenderer::Stroke);
+        if (saved != puzzles.size())
+        {
+            err << QObject::tr("Only %1 of %2 answer keys could be written to %3\n")
+                   .arg(saved).arg(puzzles.size()).arg(directory.path());
+            return 1;
+        }
+    }
+
+    out << QObject::tr("%1 of %2 puzzles generated in %3 ms\n").arg(puzzles.size()).arg(count).arg(elapsed);
+    return puzzles.size() == count ? 0 : 1;
+}
+
+// the generator has to be picked before any application object exists
+static bool isGenerating(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (qstrcmp(argv[i], "--generate") == 0 || qstrncmp(argv[i], "--generate=", 11) == 0)
+            return true;
+    }
+    return false;
+}
+
+static void setupCommandLine(QCommandLineParser &parser)
+{
+    parser.setApplicationDescription(QObject::tr("WordSearchSolver helps you solve WordSearchs fast!"));
+    parser.addHelpOption();
+    parser.addOptions({
+        { "generate", QObject::tr("Generate puzzles from the words in <file>, one word per line."), "file" },
+        { "size", QObject::tr("Size of the generated grids."), "columnsxrows", "15x15" },
+        { "count", QObject::tr("Number of puzzles to generate."), "count", "1" },
+        { "seed", QObject::tr("Seed for the generator, the same seed gives the same puzzles."), "seed" },
+        { "output", QObject::tr("Directory the .wss files are written to."), "directory", "." },
+        { "answer-keys", QObject::tr("Also write a png answer key for every generated puzzle.") }
+    });
+}
 
 int main(int argc, char *argv[])
 {
+    QCommandLineParser parser;
+    setupCommandLine(parser);
+
+    if (isGenerating(argc, argv))
+    {
+        // batch machines often have no display, the answer keys still need fonts from a gui application
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        QGuiApplication app(argc, argv);
+        parser.process(app);
+        return generatePuzzles(parser);
+    }
+
     QApplication app(argc, argv);
+    parser.process(app);
 
     MainWindow *w = new MainWindow;
     w->show();
@@ -1,5 +1,6 @@
 #include "mainwindow.h"
 #include "wordsearch/wordsearch.h"
+#include "wordsearch/answerkeyrenderer.h"
 #include <QtWidgets>
 #include <QtAlgorithms>
 #include <algorithm>
@@ -18,6 +19,7 @@ void MainWindow::newFile()
     {
         wordSearch->clear();
         wordSearch->resize(wordSearch->minimumSizeHint());
+        refreshPuzzleSelector();
         refreshWordSearch();
         setCurrentFile("");
     }
@@ -52,6 +54,44 @@ bool MainWindow::saveAs()
     return saveFile(fileName);
 }
 
+bool MainWindow::exportAnswerKey()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export Answer Key"), ".",
+                                                    tr("PNG image (*.png);;PDF document (*.pdf)"));
+    if (fileName.isEmpty())
+        return false;
+    if (QFileInfo(fileName).suffix().isEmpty())
+        fileName += ".png";
+
+    if (!AnswerKeyRenderer::save(wordSearch->puzzle(), fileName, AnswerKeyRenderer::Stroke))
+    {
+        QMessageBox::warning(this, tr("WordSearchSolver"),
+                             tr("Cannot write answer key %1").arg(fileName));
+        return false;
+    }
+    return true;
+}
+
+bool MainWindow::exportAllAnswerKeys()
+{
+    const QString directory = QFileDialog::getExistingDirectory(this, tr("Export Answer Keys To"), ".");
+    if (directory.isEmpty())
+        return false;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const int saved = AnswerKeyRenderer::saveAll(wordSearch->puzzles(), directory, "png", AnswerKeyRenderer::Stroke);
+    QApplication::restoreOverrideCursor();
+
+    if (saved != wordSearch->puzzles().size())
+    {
+        QMessageBox::warning(this, tr("WordSearchSolver"),
+                             tr("Only %1 of %2 answer keys could be written to %3")
+                             .arg(saved).arg(wordSearch->puzzles().size()).arg(directory));
+        return false;
+    }
+    return true;
+}
+
 void MainWindow::about()
 {
     QMessageBox::about(this, tr("About WordSearchSolver"),
@@ -75,6 +115,16 @@ void MainWindow::addWord()
     wordSearch->find(word);
 }
 
+void MainWindow::showPuzzle(int index)
+{
+    if (index < 0)
+        return;
+
+    wordSearch->showPuzzle(index);
+    findWordsModel->setStringList(wordSearch->puzzles().at(index).words);
+    refreshWordSearch();
+}
+
 void MainWindow::setupUi()
 {
     QWidget *centralWidget = new QWidget(this);
@@ -94,6 +144,11 @@ void MainWindow::setupUi()
     wordSearchScrollArea->setWidget(wordSearch);
     wordSearchScrollArea->setWidgetResizable(true);
 
+    puzzleSelector = new QComboBox(centralWidget);
+    puzzleSelector->setMaximumWidth(105);
+    puzzleSelector->hide();
+    connect(puzzleSelector, SIGNAL(currentIndexChanged(int)), this, SLOT(showPuzzle(int)));
+
     findWordsListView = new QListView(this);
     findWordsModel = new QStringListModel(this);
 
@@ -109,6 +164,7 @@ void MainWindow::setupUi()
     bottomRightLayout->addWidget(wordInput);
     bottomRightLayout->addWidget(enterWordButton);
 
+    rightLayout->addWidget(puzzleSelector);
     rightLayout->addWidget(findWordsListView);
     rightLayout->addLayout(bottomRightLayout);
 
@@ -163,6 +219,16 @@ void MainWindow::createActions()
     saveAsAction->setStatusTip(tr("Save the WordSearch under a new name"));
     connect(saveAsAction, SIGNAL(triggered()), this, SLOT(saveAs()));
 
+    exportAnswerKeyAction = new QAction(tr("&Export Answer Key..."), this);
+    exportAnswerKeyAction->setStatusTip(tr("Save the solved WordSearch as an image or pdf"));
+    exportAnswerKeyAction->setEnabled(false);
+    connect(exportAnswerKeyAction, SIGNAL(triggered()), this, SLOT(exportAnswerKey()));
+
+    exportAllAnswerKeysAction = new QAction(tr("Export A&ll Answer Keys..."), this);
+    exportAllAnswerKeysAction->setStatusTip(tr("Save every WordSearch found in the image as an image"));
+    exportAllAnswerKeysAction->setEnabled(false);
+    connect(exportAllAnswerKeysAction, SIGNAL(triggered()), this, SLOT(exportAllAnswerKeys()));
+
     exitAction = new QAction(tr("E&xit"), this);
     exitAction->setIcon(*exitIcon);
     exitAction->setShortcut(tr("Ctrl+Q"));
@@ -194,6 +260,10 @@ void MainWindow::createMenus()
     fileMenu->addAction(saveAction);
     fileMenu->addAction(saveAsAction);
 
+    fileMenu->addSeparator();
+    fileMenu->addAction(exportAnswerKeyAction);
+    fileMenu->addAction(exportAllAnswerKeysAction);
+
     fileMenu->addSeparator();
     fileMenu->addAction(exitAction);
 
@@ -212,6 +282,28 @@ void MainWindow::refreshWordSearch()
     update();
 }
 
+void MainWindow::refreshPuzzleSelector()
+{
+    const QList<Puzzle> &puzzles = wordSearch->puzzles();
+
+    puzzleSelector->blockSignals(true);
+    puzzleSelector->clear();
+    for (int i = 0, puzzleOnPage = 1; i != puzzles.size(); ++i)
+    {
+        if (i != 0 && puzzles[i].page != puzzles[i - 1].page)
+            puzzleOnPage = 1;
+        puzzleSelector->addItem(tr("Page %1, Puzzle %2").arg(puzzles[i].page + 1).arg(puzzleOnPage++));
+    }
+    puzzleSelector->blockSignals(false);
+
+    // only worth showing when the image held more than one word search
+    puzzleSelector->setVisible(puzzles.size() > 1);
+    exportAnswerKeyAction->setEnabled(!puzzles.isEmpty());
+    exportAllAnswerKeysAction->setEnabled(puzzles.size() > 1);
+    if (!puzzles.isEmpty())
+        findWordsModel->setStringList(puzzles.first().words);
+}
+
 bool MainWindow::okToContinue()
 {
 
@@ -245,6 +337,7 @@ bool MainWindow::loadFile(const QString &fileName)
         setCurrentFile(fileName);
     }
 
+    refreshPuzzleSelector();
     refreshWordSearch();
     return true;
 }
@@ -10,6 +10,7 @@ class QListView;
 class WordSearch;
 class QScrollArea;
 class QPushButton;
+class QComboBox;
 
 class MainWindow : public QMainWindow
 {
@@ -23,9 +24,12 @@ private slots:
     void open();
     bool save();
     bool saveAs();
+    bool exportAnswerKey();
+    bool exportAllAnswerKeys();
     void about();
 
     void addWord();
+    void showPuzzle(int index);
 
 private:
     void setupUi();
@@ -33,6 +37,7 @@ private:
     void createMenus();
 
     void refreshWordSearch();
+    void refreshPuzzleSelector();
     bool okToContinue();
     bool loadFile(const QString &fileName);
     bool saveFile(const QString &fileName);
@@ -42,6 +47,7 @@ private:
     WordSearch *wordSearch;
     QScrollArea *wordSearchScrollArea;
 
+    QComboBox *puzzleSelector;
     QListView *findWordsListView;
     QStringListModel *findWordsModel;
     QLineEdit *wordInput;
@@ -54,6 +60,8 @@ private:
     QAction *openAction;
     QAction *saveAction;
     QAction *saveAsAction;
+    QAction *exportAnswerKeyAction;
+    QAction *exportAllAnswerKeysAction;
     QAction *exitAction;
     QAction *aboutAction;
     QAction *aboutQtAction;
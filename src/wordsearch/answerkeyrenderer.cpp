@@ -0,0 +1,153 @@
+#include <QPainter>
+#include <QPdfWriter>
+#include <QPageSize>
+#include <QFileInfo>
+#include <QDir>
+#include <QHash>
+#include <QFontDatabase>
+#include <QThreadStorage>
+#include <QtConcurrent>
+#include <algorithm>
+#include "wordsearch/answerkeyrenderer.h"
+
+// letters are drawn once per thread and size, after that a puzzle is only image copies
+struct GlyphCache
+{
+    int cellSize = 0;
+    QHash<QChar, QImage> glyphs[2];     // plain, highlighted
+};
+
+static QThreadStorage<GlyphCache *> glyphCaches;
+
+static const QImage &glyph(QChar letter, bool highlighted, int cellSize)
+{
+    if (!glyphCaches.hasLocalData())
+        glyphCaches.setLocalData(new GlyphCache);
+
+    GlyphCache *cache = glyphCaches.localData();
+    if (cache->cellSize != cellSize)
+    {
+        cache->glyphs[0].clear();
+        cache->glyphs[1].clear();
+        cache->cellSize = cellSize;
+    }
+
+    QHash<QChar, QImage> &glyphs = cache->glyphs[highlighted];
+    QHash<QChar, QImage>::iterator it = glyphs.find(letter);
+    if (it == glyphs.end())
+    {
+        QImage tile(cellSize, cellSize, QImage::Format_ARGB32_Premultiplied);
+        tile.fill(Qt::transparent);
+
+        QPainter painter(&tile);
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+
+        QFont font;
+        font.setPixelSize(cellSize / 2);
+        font.setBold(highlighted);
+        painter.setFont(font);
+        painter.setPen(highlighted ? QPen(Qt::red) : QPen(Qt::black));
+        painter.drawText(tile.rect(), Qt::AlignCenter, QString(letter));
+        painter.end();
+
+        it = glyphs.insert(letter, tile);
+    }
+    return *it;
+}
+
+
+QImage AnswerKeyRenderer::render(const Puzzle &puzzle, Style style, int cellSize)
+{
+    if (puzzle.contents.isEmpty() || cellSize <= 0)
+        return QImage();
+
+    const Puzzle::size_type stride = puzzle.lineSize + 1;
+    const int rows = puzzle.contents.count('\n') + 1;
+    const int margin = cellSize / 2;
+
+    QImage image(puzzle.lineSize * cellSize + margin * 2, rows * cellSize + margin * 2,
+                 QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    auto cellCorner = [&](Puzzle::size_type ind) -> QPoint
+    {
+        return QPoint(margin + ind % stride * cellSize, margin + ind / stride * cellSize);
+    };
+
+    // strokes need to know where each word starts and ends, without them highlight the letters
+    const bool stroke = style == Stroke && !puzzle.placements.isEmpty();
+    if (stroke)
+    {
+        painter.setPen(QPen(QColor(255, 0, 0, 90), cellSize * 0.7, Qt::SolidLine, Qt::RoundCap));
+
+        const QPoint centre(cellSize / 2, cellSize / 2);
+        for (const Placement &placement : puzzle.placements)
+            painter.drawLine(cellCorner(placement.start) + centre,
+                             cellCorner(placement.letterAt(placement.length - 1, puzzle.lineSize)) + centre);
+    }
+
+    for (Puzzle::size_type ind = 0; ind < puzzle.contents.size(); ++ind)
+    {
+        if (puzzle.contents[ind] != '\n')
+        {
+            const bool highlighted = !stroke && puzzle.positions.contains(ind);
+            painter.drawImage(cellCorner(ind), glyph(puzzle.contents[ind], highlighted, cellSize));
+        }
+    }
+    return image;
+}
+
+bool AnswerKeyRenderer::save(const Puzzle &puzzle, const QString &fileName, Style style, int cellSize)
+{
+    const QImage image = render(puzzle, style, cellSize);
+    if (image.isNull())
+        return false;
+
+    if (QFileInfo(fileName).suffix().compare("pdf", Qt::CaseInsensitive) != 0)
+        return image.save(fileName);
+
+    // one page the size of the grid, a pixel of the image becomes a point on the page
+    QPdfWriter writer(fileName);
+    writer.setPageSize(QPageSize(QSizeF(image.size()), QPageSize::Point, QString(), QPageSize::ExactMatch));
+    writer.setPageMargins(QMarginsF(0, 0, 0, 0));
+
+    QPainter painter;
+    if (!painter.begin(&writer))
+        return false;
+    painter.drawImage(QRect(0, 0, writer.width(), writer.height()), image);
+    return painter.end();
+}
+
+int AnswerKeyRenderer::saveAll(const QList<Puzzle> &puzzles, const QString &directory, const QString &suffix,
+                               Style style, int cellSize)
+{
+    QList<ExportJob> jobs;
+    for (int i = 0; i != puzzles.size(); ++i)
+    {
+        const QString name = QString("answerkey%1.%2").arg(i + 1, 4, 10, QChar('0')).arg(suffix);
+        const ExportJob job = { &puzzles[i], QDir(directory).filePath(name), style, cellSize, false };
+        jobs << job;
+    }
+
+    // some platforms can only draw text from the gui thread
+    if (QFontDatabase::supportsThreadedFontRendering())
+        QtConcurrent::blockingMap(jobs, exportJob);
+    else
+        std::for_each(jobs.begin(), jobs.end(), exportJob);
+
+    int saved = 0;
+    for (const ExportJob &job : jobs)
+    {
+        if (job.saved)
+            ++saved;
+    }
+    return saved;
+}
+
+void AnswerKeyRenderer::exportJob(ExportJob &job)
+{
+    job.saved = save(*job.puzzle, job.fileName, job.style, job.cellSize);
+}
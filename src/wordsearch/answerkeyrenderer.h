@@ -0,0 +1,36 @@
+#ifndef ANSWERKEYRENDERER_H
+#define ANSWERKEYRENDERER_H
+
+#include <QImage>
+#include <QString>
+#include <QList>
+#include "wordsearch/puzzle.h"
+
+// Draws solved puzzles offscreen, no WordSearch widget needed. Every thread keeps
+// its own cache of letter images, so any number of puzzles can be drawn at once.
+class AnswerKeyRenderer
+{
+public:
+    enum Style { Highlight, Stroke };
+
+    static QImage render(const Puzzle &puzzle, Style style = Highlight, int cellSize = 40);
+
+    // png, pdf or any other image format Qt can write, picked by the file's suffix
+    static bool save(const Puzzle &puzzle, const QString &fileName, Style style = Highlight, int cellSize = 40);
+    static int saveAll(const QList<Puzzle> &puzzles, const QString &directory, const QString &suffix,
+                       Style style = Highlight, int cellSize = 40);
+
+private:
+    struct ExportJob
+    {
+        const Puzzle *puzzle;
+        QString fileName;
+        Style style;
+        int cellSize;
+        bool saved;
+    };
+
+    static void exportJob(ExportJob &job);
+};
+
+#endif // ANSWERKEYRENDERER_H
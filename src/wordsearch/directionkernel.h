@@ -0,0 +1,126 @@
+#ifndef DIRECTIONKERNEL_H
+#define DIRECTIONKERNEL_H
+
+#include <QChar>
+#include <QVector>
+#include <QtGlobal>
+#include "wordsearch/puzzle.h"
+
+// Compares the rest of a word with the grid, one letter every step characters.
+// Length is the word's length when it is known at compile time, so short words
+// are compared without a loop; 0 means any length.
+template <int Length>
+struct LetterMatcher
+{
+    static bool matches(const QChar *letter, Placement::size_type step, const QChar *word, Placement::size_type)
+    {
+        bool matches = true;
+        for (int i = 1; i != Length; ++i)
+            matches &= letter[i * step] == word[i];
+        return matches;
+    }
+};
+
+template <>
+struct LetterMatcher<0>
+{
+    static bool matches(const QChar *letter, Placement::size_type step, const QChar *word, Placement::size_type length)
+    {
+        for (Placement::size_type i = 1; i != length; ++i)
+        {
+            if (letter[i * step] != word[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+// what the kernels do with each placement they find
+struct PlacementCollector
+{
+    QVector<Placement> &placements;
+
+    void found(Placement::size_type start, int dx, int dy, Placement::size_type length)
+    {
+        placements << Placement{start, dx, dy, length};
+    }
+};
+
+// checking a generated puzzle only needs to know how many there are
+struct PlacementCounter
+{
+    int count;
+
+    void found(Placement::size_type, int, int, Placement::size_type)
+    {
+        ++count;
+    }
+};
+
+// Finds every placement of a word going dx columns and dy rows per letter.
+// Rows end in '\n', which no word holds, so a word running off the side of the
+// grid fails on the newline; only starts whose last letter is inside the grid
+// are tried and no other bounds checks are needed.
+template <int DX, int DY, int Length, typename Output>
+void scanDirection(const QChar *grid, Placement::size_type size, Placement::size_type lineSize,
+                   const QChar *word, Placement::size_type length, Output &output)
+{
+    typedef Placement::size_type size_type;
+
+    const size_type step = DY * (lineSize + 1) + DX;
+    const size_type reach = (length - 1) * step;
+    const size_type first = qMax(size_type(0), -reach);
+    const size_type last = qMin(size, size - reach);
+
+    for (size_type ind = first; ind < last; ++ind)
+    {
+        if (grid[ind] == word[0] && LetterMatcher<Length>::matches(grid + ind, step, word, length))
+            output.found(ind, DX, DY, length);
+    }
+}
+
+template <int Length, typename Output>
+void scanAllDirections(const QChar *grid, Placement::size_type size, Placement::size_type lineSize,
+                       const QChar *word, Placement::size_type length, Output &output)
+{
+    scanDirection< 1,  0, Length>(grid, size, lineSize, word, length, output);     // left to right
+    scanDirection<-1,  0, Length>(grid, size, lineSize, word, length, output);     // right to left
+    scanDirection< 0,  1, Length>(grid, size, lineSize, word, length, output);     // top to bottom
+    scanDirection< 0, -1, Length>(grid, size, lineSize, word, length, output);     // bottom to top
+    scanDirection< 1,  1, Length>(grid, size, lineSize, word, length, output);     // down to the right
+    scanDirection< 1, -1, Length>(grid, size, lineSize, word, length, output);     // up to the right
+    scanDirection<-1,  1, Length>(grid, size, lineSize, word, length, output);     // down to the left
+    scanDirection<-1, -1, Length>(grid, size, lineSize, word, length, output);     // up to the left
+}
+
+// short words get a kernel with the comparison unrolled
+template <typename Output>
+void scanWord(const QString &contents, Placement::size_type lineSize, const QString &word, Output &output)
+{
+    const QChar *grid = contents.constData();
+    const QChar *letters = word.constData();
+
+    switch (word.size())
+    {
+    case 0:
+    case 1:
+        break;
+    case 2:
+        scanAllDirections<2>(grid, contents.size(), lineSize, letters, word.size(), output);
+        break;
+    case 3:
+        scanAllDirections<3>(grid, contents.size(), lineSize, letters, word.size(), output);
+        break;
+    case 4:
+        scanAllDirections<4>(grid, contents.size(), lineSize, letters, word.size(), output);
+        break;
+    case 5:
+        scanAllDirections<5>(grid, contents.size(), lineSize, letters, word.size(), output);
+        break;
+    default:
+        scanAllDirections<0>(grid, contents.size(), lineSize, letters, word.size(), output);
+        break;
+    }
+}
+
+#endif // DIRECTIONKERNEL_H
@@ -0,0 +1,344 @@
+#include <QtConcurrent>
+#include <QObject>
+#include <algorithm>
+#include "wordsearch/generator.h"
+#include "wordsearch/solver.h"
+
+static const int directions[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+                                      { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+static const int placementBudget = 2000;
+static const int refillRounds = 20;
+static const int attemptsPerPuzzle = 50;
+
+static int greatestCommonDivisor(int a, int b)
+{
+    while (b != 0)
+    {
+        const int remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+static QString reversed(const QString &word)
+{
+    QString reversedWord(word.size(), Qt::Uninitialized);
+    std::reverse_copy(word.begin(), word.end(), reversedWord.begin());
+    return reversedWord;
+}
+
+// how often a word can be read in text, forwards or backwards, overlaps included
+static int occurrences(const QString &text, const QString &word)
+{
+    const QString backwards = reversed(word);
+    int found = 0;
+    for (int from = text.indexOf(word); from != -1; from = text.indexOf(word, from + 1))
+        ++found;
+    if (backwards != word)
+    {
+        for (int from = text.indexOf(backwards); from != -1; from = text.indexOf(backwards, from + 1))
+            ++found;
+    }
+    return found;
+}
+
+
+Generator::Generator(size_type columns, size_type rows, quint32 seed)
+    : columns(columns), rows(rows), random(seed)
+{
+}
+
+bool Generator::generate(const QStringList &words, Puzzle &puzzle)
+{
+    if (columns <= 0 || rows <= 0)
+        return false;
+
+    for (const QString &word : words)
+    {
+        if (word.size() < 2 || word.size() > qMax(columns, rows))
+            return false;
+    }
+
+    // the same list is usually given again and again, it only has to be studied once
+    if (words != allWords || wordInfo.size() != words.size())
+        prepareWords(words);
+
+    grid = QString(rows * (columns + 1) - 1, QChar());
+    for (size_type row = 1; row < rows; ++row)
+        grid[row * (columns + 1) - 1] = '\n';
+    filler.fill(false, grid.size());
+
+    placed.resize(toPlace.size());
+    budget = placementBudget;
+    if (!placeWords(0))
+        return false;
+
+    fill();
+    if (!removeDuplicates())
+        return false;
+
+    puzzle = Puzzle();
+    puzzle.contents = grid;
+    Solver::gridSize(puzzle.contents, puzzle.lineSize, puzzle.rowSize);
+    puzzle.words = words;
+
+    // every word is there exactly once and the placed words already say where
+    for (int i = 0; i != allWords.size(); ++i)
+    {
+        const WordInfo &info = wordInfo[i];
+        const Placement &container = placed[info.placedWord];
+        const int direction = info.reversed ? -1 : 1;
+        puzzle.placements << Placement{ container.letterAt(info.offset, columns), container.dx * direction,
+                                        container.dy * direction, allWords[i].size() };
+    }
+    puzzle.positions = Solver::positions(puzzle.placements, puzzle.lineSize);
+    return true;
+}
+
+bool Generator::checkWords(const QStringList &words, size_type columns, size_type rows, QString *problem)
+{
+    const QStringList toPlace = wordsToPlace(words);
+    for (const QString &word : words)
+    {
+        if (word.size() < 2)
+        {
+            *problem = QObject::tr("%1 is shorter than two letters").arg(word);
+            return false;
+        }
+
+        if (word.size() > qMax(columns, rows))
+        {
+            *problem = QObject::tr("%1 is longer than the grid is wide or tall").arg(word);
+            return false;
+        }
+
+        if (toPlace.contains(word))
+            continue;
+
+        // only found inside longer words, and there more than once
+        int found = 0;
+        for (const QString &placed : toPlace)
+            found += occurrences(placed, word);
+
+        if (found > 1)
+        {
+            *problem = QObject::tr("%1 appears %2 times inside the other words").arg(word).arg(found);
+            return false;
+        }
+    }
+    return true;
+}
+
+QList<Puzzle> Generator::generateMany(const QStringList &words, size_type columns, size_type rows,
+                                      int count, quint32 seed)
+{
+    QString problem;
+    if (!checkWords(words, columns, rows, &problem))
+        return QList<Puzzle>();
+
+    QList<GenerateJob> jobs;
+    for (int i = 0; i < count; ++i)
+    {
+        GenerateJob job;
+        job.words = words;
+        job.columns = columns;
+        job.rows = rows;
+        job.seed = seed + i;
+        job.generated = false;
+        jobs << job;
+    }
+
+    QtConcurrent::blockingMap(jobs, generateJob);
+
+    QList<Puzzle> puzzles;
+    for (const GenerateJob &job : jobs)
+    {
+        if (job.generated)
+            puzzles << job.puzzle;
+    }
+    return puzzles;
+}
+
+void Generator::generateJob(GenerateJob &job)
+{
+    Generator generator(job.columns, job.rows, job.seed);
+    for (int attempt = 0; attempt != attemptsPerPuzzle && !job.generated; ++attempt)
+        job.generated = generator.generate(job.words, job.puzzle);
+}
+
+// a word inside a longer one(either way round) is found there already,
+// placing it on its own as well would always give it twice
+QStringList Generator::wordsToPlace(const QStringList &words)
+{
+    QStringList longestFirst = words;
+    std::stable_sort(longestFirst.begin(), longestFirst.end(),
+                     [](const QString &a, const QString &b) { return a.size() > b.size(); });
+
+    QStringList toPlace;
+    for (const QString &word : longestFirst)
+    {
+        bool insideLongerWord = false;
+        for (const QString &placed : toPlace)
+        {
+            if (placed.contains(word) || placed.contains(reversed(word)))
+                insideLongerWord = true;
+        }
+
+        if (!insideLongerWord)
+            toPlace << word;
+    }
+    return toPlace;
+}
+
+void Generator::prepareWords(const QStringList &words)
+{
+    allWords = words;
+    toPlace = wordsToPlace(words);
+
+    wordInfo.clear();
+    for (const QString &word : words)
+    {
+        WordInfo info = { -1, 0, false, Solver::isPalindrome(word) };
+        for (int i = 0; i != toPlace.size() && info.placedWord == -1; ++i)
+        {
+            int offset = toPlace[i].indexOf(word);
+            if (offset != -1)
+            {
+                info.placedWord = i;
+                info.offset = offset;
+            }
+            else if ((offset = toPlace[i].indexOf(reversed(word))) != -1)
+            {
+                info.placedWord = i;
+                info.offset = offset + word.size() - 1;
+                info.reversed = true;
+            }
+        }
+        wordInfo << info;
+    }
+}
+
+bool Generator::placeWords(int index)
+{
+    if (index == toPlace.size())
+        return true;
+
+    const QString &word = toPlace[index];
+
+    // visit every start and direction once, stepping by a stride that shares no factor
+    // with the number of candidates gives a different order for every puzzle
+    const int candidates = grid.size() * 8;
+    int stride = std::uniform_int_distribution<int>(1, candidates)(random);
+    while (greatestCommonDivisor(stride, candidates) != 1)
+        ++stride;
+    int candidate = std::uniform_int_distribution<int>(0, candidates - 1)(random);
+
+    for (int i = 0; i != candidates; ++i, candidate = (candidate + stride) % candidates)
+    {
+        const int *direction = directions[candidate % 8];
+        const Placement placement = { candidate / 8, direction[0], direction[1], word.size() };
+        if (!inGrid(placement) || !fits(word, placement))
+            continue;
+
+        if (--budget < 0)
+            return false;
+
+        // remember the cells this word filled so they can be emptied again
+        QVector<size_type> filled;
+        for (size_type letter = 0; letter != word.size(); ++letter)
+        {
+            const size_type cell = placement.letterAt(letter, columns);
+            if (grid[cell].isNull())
+            {
+                grid[cell] = word[letter];
+                filled << cell;
+            }
+        }
+
+        placed[index] = placement;
+        if (placeWords(index + 1))
+            return true;
+
+        for (size_type cell : filled)
+            grid[cell] = QChar();
+
+        if (budget < 0)
+            return false;
+    }
+    return false;
+}
+
+bool Generator::inGrid(const Placement &placement) const
+{
+    const size_type column = placement.start % (columns + 1);
+    const size_type row = placement.start / (columns + 1);
+    const size_type lastColumn = column + placement.dx * (placement.length - 1);
+    const size_type lastRow = row + placement.dy * (placement.length - 1);
+
+    // the newline ending each row is not a cell
+    return column < columns && lastColumn >= 0 && lastColumn < columns && lastRow >= 0 && lastRow < rows;
+}
+
+bool Generator::fits(const QString &word, const Placement &placement) const
+{
+    for (size_type letter = 0; letter != word.size(); ++letter)
+    {
+        const QChar cell = grid[placement.letterAt(letter, columns)];
+        if (!cell.isNull() && cell != word[letter])
+            return false;
+    }
+    return true;
+}
+
+void Generator::fill()
+{
+    for (size_type cell = 0; cell != grid.size(); ++cell)
+    {
+        filler[cell] = grid[cell].isNull();
+        if (filler[cell])
+            grid[cell] = randomLetter();
+    }
+}
+
+bool Generator::removeDuplicates()
+{
+    for (int round = 0; round != refillRounds; ++round)
+    {
+        bool unique = true;
+        for (int i = 0; i != allWords.size(); ++i)
+        {
+            if (Solver::count(grid, columns, allWords[i], wordInfo[i].palindrome) == 1)
+                continue;
+            unique = false;
+
+            // the placed words themselves can't change, only the random letters around them
+            bool redrawn = false;
+            for (const Placement &placement : Solver::findPlacements(grid, columns, allWords[i]))
+            {
+                for (size_type letter = 0; letter != placement.length; ++letter)
+                {
+                    const size_type cell = placement.letterAt(letter, columns);
+                    if (filler[cell])
+                    {
+                        grid[cell] = randomLetter();
+                        redrawn = true;
+                    }
+                }
+            }
+
+            if (!redrawn)
+                return false;
+        }
+
+        if (unique)
+            return true;
+    }
+    return false;
+}
+
+QChar Generator::randomLetter()
+{
+    return QChar('A' + std::uniform_int_distribution<int>(0, 25)(random));
+}
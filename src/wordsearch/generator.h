@@ -0,0 +1,75 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <random>
+#include "wordsearch/puzzle.h"
+
+// Builds puzzles in which every word of the list can be found exactly once.
+// Words are placed longest first by a backtracking search, the free cells get
+// random letters and whenever those letters spell a word a second time they
+// are drawn again. The solver has the final say on every puzzle.
+class Generator
+{
+public:
+    typedef Puzzle::size_type size_type;
+
+    Generator(size_type columns, size_type rows, quint32 seed);
+
+    bool generate(const QStringList &words, Puzzle &puzzle);
+
+    // false, with the reason in problem, for lists no grid of this size can hold
+    static bool checkWords(const QStringList &words, size_type columns, size_type rows, QString *problem);
+
+    // spread over all cores, puzzles that could not be built are left out
+    static QList<Puzzle> generateMany(const QStringList &words, size_type columns, size_type rows,
+                                      int count, quint32 seed);
+
+private:
+    struct GenerateJob
+    {
+        QStringList words;
+        size_type columns;
+        size_type rows;
+        quint32 seed;
+        Puzzle puzzle;
+        bool generated;
+    };
+
+    static void generateJob(GenerateJob &job);
+    static QStringList wordsToPlace(const QStringList &words);
+
+    // where each word of the list can be read once the words are placed
+    struct WordInfo
+    {
+        int placedWord;         // index in toPlace of the word it is part of
+        int offset;             // its first letter within that word
+        bool reversed;          // read backwards within that word
+        bool palindrome;
+    };
+
+    void prepareWords(const QStringList &words);
+    bool placeWords(int index);
+    bool inGrid(const Placement &placement) const;
+    bool fits(const QString &word, const Placement &placement) const;
+    void fill();
+    bool removeDuplicates();
+    QChar randomLetter();
+
+    size_type columns;
+    size_type rows;
+    std::mt19937 random;
+
+    QString grid;               // laid out like Puzzle::contents, empty cells are null
+    QVector<bool> filler;       // cells holding a random letter rather than part of a word
+    QStringList allWords;
+    QStringList toPlace;        // longest first, without words that are part of a longer one
+    QVector<WordInfo> wordInfo; // one for every word of allWords
+    QVector<Placement> placed;  // one for every word of toPlace
+    int budget = 0;             // placements left to try before giving up on this layout
+};
+
+#endif // GENERATOR_H
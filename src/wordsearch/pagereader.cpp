@@ -0,0 +1,328 @@
+#include <QImageReader>
+#include <QThreadStorage>
+#include <QHash>
+#include <QRegularExpression>
+#include <QtConcurrent>
+#include <algorithm>
+#include "wordsearch/pagereader.h"
+#include "wordsearch/solver.h"
+#include <leptonica/allheaders.h>
+#include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
+
+// a TessBaseAPI can only be used by one thread at a time, so every worker thread
+// keeps its own and only hands it a new image when it moves on to another page
+struct OcrEngine
+{
+    tesseract::TessBaseAPI tess;
+    qint64 imageKey = 0;
+};
+
+static QThreadStorage<OcrEngine *> ocrEngines;
+
+static tesseract::TessBaseAPI &ocrEngineFor(const QImage &page)
+{
+    if (!ocrEngines.hasLocalData())
+    {
+        OcrEngine *engine = new OcrEngine;
+        engine->tess.Init(NULL, "eng");
+        ocrEngines.setLocalData(engine);
+    }
+
+    OcrEngine *engine = ocrEngines.localData();
+    if (engine->imageKey != page.cacheKey())
+    {
+        engine->tess.SetImage(page.constBits(), page.width(), page.height(), 1, page.bytesPerLine());
+        engine->tess.SetSourceResolution(300);
+        engine->imageKey = page.cacheKey();
+    }
+    return engine->tess;
+}
+
+// squared distance between the edges of two rectangles, 0 if they touch
+static qint64 rectGap(const QRect &a, const QRect &b)
+{
+    const qint64 dx = qMax(0, qMax(a.left() - b.right(), b.left() - a.right()));
+    const qint64 dy = qMax(0, qMax(a.top() - b.bottom(), b.top() - a.bottom()));
+    return dx * dx + dy * dy;
+}
+
+// smaller blocks of letters are taken for text rather than a grid
+static const int minimumGridSize = 5;
+
+
+QList<Puzzle> PageReader::read(const QString &imageFile)
+{
+    // multi-page formats(tiff) hold one page per image
+    QList<Region> pages;
+    QImageReader reader(imageFile);
+    do
+    {
+        QImage image = reader.read();
+        if (image.isNull())
+            break;
+
+        Region page;
+        page.page = image.convertToFormat(QImage::Format_Grayscale8);
+        page.pageNumber = pages.size();
+        page.rect = page.page.rect();
+        pages << page;
+    } while (reader.jumpToNextImage());
+
+    if (pages.isEmpty())
+        return QList<Puzzle>();
+
+    // layout analysis per page, then the ocr itself per block, both spread over all cores
+    QList<Region> regions;
+    const QList<QList<Region> > pageRegions = QtConcurrent::blockingMapped<QList<QList<Region> > >(pages, findRegions);
+    for (const QList<Region> &blocks : pageRegions)
+        regions += blocks;
+    regions = QtConcurrent::blockingMapped<QList<Region> >(regions, readRegion);
+
+    // a page without any recognisable grid is read as one grid, e.g. a photo of a single word search
+    QList<Region> pagesWithoutGrid;
+    for (const Region &page : pages)
+    {
+        auto hasGrid = [&]() -> bool
+        {
+            for (const Region &region : regions)
+                if (region.pageNumber == page.pageNumber && region.grid)
+                    return true;
+            return false;
+        };
+
+        if (!hasGrid())
+            pagesWithoutGrid << page;
+    }
+    regions += QtConcurrent::blockingMapped<QList<Region> >(pagesWithoutGrid, readWholePage);
+
+    // the whole-page fallbacks were added last, put every puzzle back in page order
+    QList<Puzzle> puzzles = pairRegions(regions);
+    std::stable_sort(puzzles.begin(), puzzles.end(),
+                     [](const Puzzle &a, const Puzzle &b) { return a.page < b.page; });
+    QtConcurrent::blockingMap(puzzles, Solver::solve);
+    return puzzles;
+}
+
+QList<PageReader::Region> PageReader::findRegions(const Region &page)
+{
+    tesseract::TessBaseAPI &tess = ocrEngineFor(page.page);
+    tess.SetRectangle(0, 0, page.page.width(), page.page.height());
+
+    QList<Region> regions;
+    Boxa *boxes = tess.GetComponentImages(tesseract::RIL_BLOCK, true, NULL, NULL);
+    if (!boxes)
+        return regions;
+
+    for (int i = 0; i < boxes->n; ++i)
+    {
+        BOX *box = boxaGetBox(boxes, i, L_CLONE);
+        Region region = page;
+        region.rect = QRect(box->x, box->y, box->w, box->h);
+        regions << region;
+        boxDestroy(&box);
+    }
+    boxaDestroy(&boxes);
+    return regions;
+}
+
+PageReader::Region PageReader::readRegion(const Region &region)
+{
+    tesseract::TessBaseAPI &tess = ocrEngineFor(region.page);
+    tess.SetRectangle(region.rect.x(), region.rect.y(), region.rect.width(), region.rect.height());
+
+    Region result = region;
+    char *txt = tess.GetUTF8Text();
+
+    // average confidence value is greater than 50
+    if (txt && tess.MeanTextConf() > 50)
+    {
+        result.text = QString::fromUtf8(txt);
+        result.readable = true;
+        result.grid = isGrid(result.text);
+        if (!result.grid)
+            result.entries = readEntries(tess);
+    }
+    delete[] txt;
+    return result;
+}
+
+PageReader::Region PageReader::readWholePage(const Region &page)
+{
+    Region whole = readRegion(page);
+    whole.grid = whole.readable;
+    return whole;
+}
+
+// A word bank lists one word per line, or sets the words out in columns. Words
+// of one entry are a space apart, a gap wider than a letter is tall starts the
+// next entry, so "ICE CREAM" stays one word while columns are still split.
+QStringList PageReader::readEntries(tesseract::TessBaseAPI &tess)
+{
+    QStringList entries;
+    tesseract::ResultIterator *it = tess.GetIterator();
+    if (!it)
+        return entries;
+
+    int previousRight = 0;
+    do
+    {
+        if (it->Empty(tesseract::RIL_WORD))
+            continue;
+
+        int left, top, right, bottom;
+        it->BoundingBox(tesseract::RIL_WORD, &left, &top, &right, &bottom);
+        char *txt = it->GetUTF8Text(tesseract::RIL_WORD);
+
+        const bool newLine = it->IsAtBeginningOf(tesseract::RIL_TEXTLINE);
+        if (entries.isEmpty() || newLine || left - previousRight > bottom - top)
+            entries << QString();
+        else
+            entries.last() += ' ';
+        entries.last() += QString::fromUtf8(txt);
+
+        previousRight = right;
+        delete[] txt;
+    } while (it->Next(tesseract::RIL_WORD));
+
+    delete it;
+    return entries;
+}
+
+QList<Puzzle> PageReader::pairRegions(const QList<Region> &regions)
+{
+    QList<Puzzle> puzzles;
+    for (const Region &region : regions)
+    {
+        if (region.readable && region.grid)
+        {
+            Puzzle puzzle;
+            puzzle.contents = gridContents(region.text);
+            Solver::gridSize(puzzle.contents, puzzle.lineSize, puzzle.rowSize);
+            puzzle.page = region.pageNumber;
+            puzzle.gridRect = region.rect;
+            puzzles << puzzle;
+        }
+    }
+
+    // every word bank belongs to the closest grid on the same page, as long as it
+    // is printed within a grid's size of it; other text on the page is left alone
+    for (const Region &region : regions)
+    {
+        if (!region.readable || region.grid)
+            continue;
+
+        Puzzle *closest = NULL;
+        for (Puzzle &puzzle : puzzles)
+        {
+            const qint64 reach = qMax(puzzle.gridRect.width(), puzzle.gridRect.height());
+            const qint64 gap = rectGap(puzzle.gridRect, region.rect);
+            if (puzzle.page == region.pageNumber && gap <= reach * reach &&
+                    (!closest || gap < rectGap(closest->gridRect, region.rect)))
+                closest = &puzzle;
+        }
+
+        if (closest)
+            closest->words += wordBank(region.entries);
+    }
+    return puzzles;
+}
+
+// Grid rows are letters set apart by spaces, or one run of letters. A word bank
+// line can look like the latter, one word alone, but then a list of words that
+// happen to be the same length is taller than it is wide, a grid is not.
+// Every row holds about the same amount of letters, tesseract drops or adds one
+// here and there.
+bool PageReader::isGrid(const QString &text)
+{
+    bool spaced = true;
+    QStringList rows;
+    for (const QString &line : text.toUpper().split('\n'))
+    {
+        const QStringList tokens = line.simplified().split(' ');
+        if (tokens.first().isEmpty())
+            continue;
+
+        int letters = 0;
+        for (const QString &token : tokens)
+        {
+            if (token.size() == 1)
+                ++letters;
+        }
+
+        // one long word or mostly single letters
+        if (tokens.size() == 1)
+            spaced = false;
+        else if (tokens.size() < minimumGridSize || letters * 10 < tokens.size() * 8)
+            return false;
+
+        rows << tokens.join("");
+    }
+
+    const int columns = commonRowLength(rows);
+    if (rows.size() < minimumGridSize || columns < minimumGridSize || (!spaced && columns < rows.size()))
+        return false;
+
+    int fullRows = 0;
+    for (const QString &row : rows)
+    {
+        if (qAbs(row.size() - columns) > 1)
+            return false;
+        if (row.size() == columns)
+            ++fullRows;
+    }
+    return fullRows * 2 >= rows.size();
+}
+
+// the length most rows have, the one every row is made to have
+int PageReader::commonRowLength(const QStringList &rows)
+{
+    QHash<int, int> lengths;
+    int common = 0;
+    for (const QString &row : rows)
+    {
+        if (++lengths[row.size()] > lengths.value(common))
+            common = row.size();
+    }
+    return common;
+}
+
+QString PageReader::gridContents(const QString &text)
+{
+    QString contents = text.toUpper();
+    // tesseract detects capital o as 0(zero) at times, need to replace with O(capital o)
+    contents.replace('0', 'O');
+    contents.replace(" ", "");
+
+    QStringList rows;
+    for (const QString &row : contents.split('\n'))
+    {
+        if (!row.trimmed().isEmpty())
+            rows << row.trimmed();
+    }
+
+    // a letter tesseract missed becomes a '?' at the end of its row, so the
+    // rows below still line up; one it made up too many is cut off
+    const int columns = commonRowLength(rows);
+    for (QString &row : rows)
+        row = row.leftJustified(columns, '?', true);
+    return rows.join('\n');
+}
+
+// cleaned up the same way as words typed into the window, so an entry of
+// several words is searched for as one
+QStringList PageReader::wordBank(const QStringList &entries)
+{
+    QStringList words;
+    for (QString word : entries)
+    {
+        word = word.toUpper();
+        word = word.simplified();
+        word.replace(" ", "");
+        word.replace('0', 'O');
+        word.remove(QRegularExpression("[^A-Z]"));
+        if (word.size() > 1)
+            words << word;
+    }
+    return words;
+}
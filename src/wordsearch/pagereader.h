@@ -0,0 +1,43 @@
+#ifndef PAGEREADER_H
+#define PAGEREADER_H
+
+#include <QString>
+#include <QList>
+#include <QImage>
+#include <QRect>
+#include "wordsearch/puzzle.h"
+
+namespace tesseract { class TessBaseAPI; }
+
+// Reads every page of a scan, splits each page into the grids and word banks
+// tesseract finds on it and gives back one solved puzzle per grid.
+class PageReader
+{
+public:
+    static QList<Puzzle> read(const QString &imageFile);
+
+private:
+    struct Region
+    {
+        QImage page;
+        int pageNumber = 0;
+        QRect rect;
+        QString text;
+        QStringList entries;    // word bank entries, one per line or column
+        bool readable = false;
+        bool grid = false;
+    };
+
+    static QList<Region> findRegions(const Region &page);
+    static Region readRegion(const Region &region);
+    static Region readWholePage(const Region &page);
+    static QStringList readEntries(tesseract::TessBaseAPI &tess);
+    static QList<Puzzle> pairRegions(const QList<Region> &regions);
+
+    static bool isGrid(const QString &text);
+    static int commonRowLength(const QStringList &rows);
+    static QString gridContents(const QString &text);
+    static QStringList wordBank(const QStringList &entries);
+};
+
+#endif // PAGEREADER_H
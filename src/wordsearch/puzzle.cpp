@@ -0,0 +1,46 @@
+#include <QDataStream>
+#include "wordsearch/puzzle.h"
+
+QDataStream &operator<<(QDataStream &out, const Placement &placement)
+{
+    return out << qint32(placement.start) << qint32(placement.dx) << qint32(placement.dy)
+               << qint32(placement.length);
+}
+
+QDataStream &operator>>(QDataStream &in, Placement &placement)
+{
+    qint32 start, dx, dy, length;
+    in >> start >> dx >> dy >> length;
+    placement = Placement{ start, dx, dy, length };
+    return in;
+}
+
+bool Puzzle::write(QIODevice *device) const
+{
+    QDataStream out(device);
+    out.setVersion(QDataStream::Qt_5_4);
+
+    out << quint32(MagicNumber);
+    out << contents << lineSize << rowSize << positions << words << placements;
+    return out.status() == QDataStream::Ok;
+}
+
+bool Puzzle::read(QIODevice *device)
+{
+    QDataStream in(device);
+    in.setVersion(QDataStream::Qt_5_4);
+
+    quint32 magic;
+    in >> magic;
+    if (magic != MagicNumber)
+        return false;
+
+    in >> contents >> lineSize >> rowSize >> positions;
+    placements.clear();
+    words.clear();
+    if (!in.atEnd())
+        in >> words;
+    if (!in.atEnd())
+        in >> placements;
+    return true;
+}
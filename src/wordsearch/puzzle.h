@@ -0,0 +1,55 @@
+#ifndef PUZZLE_H
+#define PUZZLE_H
+
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QRect>
+#include <QVector>
+
+class QIODevice;
+class QDataStream;
+
+// a found word, each letter is dx columns and dy rows on from the one before
+struct Placement
+{
+    typedef QString::size_type size_type;
+
+    size_type start;
+    int dx;
+    int dy;
+    size_type length;
+
+    // rows are separated by '\n', so a row is lineSize + 1 characters long
+    size_type letterAt(size_type letter, size_type lineSize) const
+    {
+        return start + letter * (dy * (lineSize + 1) + dx);
+    }
+};
+Q_DECLARE_TYPEINFO(Placement, Q_PRIMITIVE_TYPE);
+
+QDataStream &operator<<(QDataStream &out, const Placement &placement);
+QDataStream &operator>>(QDataStream &in, Placement &placement);
+
+// one word search grid together with the word bank printed next to it
+struct Puzzle
+{
+    typedef QString::size_type size_type;
+
+    QString contents;               // letters of the grid, one row per line
+    size_type lineSize = 0;
+    size_type rowSize = 0;
+    QStringList words;
+    QSet<size_type> positions;      // letters that belong to a found word
+    QVector<Placement> placements;
+
+    int page = 0;                   // where the grid was found in the scan
+    QRect gridRect;
+
+    // .wss files, the word list and placements follow the grid so older files still load
+    enum { MagicNumber = 0x7F51C883 };
+    bool write(QIODevice *device) const;
+    bool read(QIODevice *device);
+};
+
+#endif // PUZZLE_H
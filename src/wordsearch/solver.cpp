@@ -0,0 +1,63 @@
+#include <QTextStream>
+#include "wordsearch/solver.h"
+#include "wordsearch/puzzle.h"
+#include "wordsearch/directionkernel.h"
+
+QVector<Placement> Solver::findPlacements(const QString &contents, size_type lineSize, const QString &word)
+{
+    QVector<Placement> placements;
+    PlacementCollector collector = { placements };
+    scanWord(contents, lineSize, word, collector);
+    return placements;
+}
+
+int Solver::count(const QString &contents, size_type lineSize, const QString &word, bool palindrome)
+{
+    PlacementCounter counter = { 0 };
+    scanWord(contents, lineSize, word, counter);
+
+    // a palindrome is found once from each end
+    return palindrome ? counter.count / 2 : counter.count;
+}
+
+bool Solver::isPalindrome(const QString &word)
+{
+    for (size_type front = 0, back = word.size() - 1; front < back; ++front, --back)
+    {
+        if (word[front] != word[back])
+            return false;
+    }
+    return true;
+}
+
+QSet<Solver::size_type> Solver::positions(const QVector<Placement> &placements, size_type lineSize)
+{
+    QSet<size_type> positions;
+    for (const Placement &placement : placements)
+    {
+        for (size_type letter = 0; letter != placement.length; ++letter)
+            positions.insert(placement.letterAt(letter, lineSize));
+    }
+    return positions;
+}
+
+void Solver::solve(Puzzle &puzzle)
+{
+    for (const QString &word : puzzle.words)
+        puzzle.placements += findPlacements(puzzle.contents, puzzle.lineSize, word);
+    puzzle.positions += positions(puzzle.placements, puzzle.lineSize);
+}
+
+void Solver::gridSize(const QString &contents, size_type &lineSize, size_type &rowSize)
+{
+    QString text = contents;
+    QTextStream textStream(&text, QIODevice::ReadOnly);
+
+    // get amount of letters in each row(line)
+    lineSize = textStream.readLine().size();
+
+    // get number of rows/ get amount of letters in each column
+    rowSize = 0;
+    while (!textStream.readLine().isNull())
+        ++rowSize;
+}
@@ -0,0 +1,27 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <QString>
+#include <QSet>
+#include <QVector>
+
+struct Puzzle;
+struct Placement;
+
+class Solver
+{
+public:
+    typedef QString::size_type size_type;
+
+    static QVector<Placement> findPlacements(const QString &contents, size_type lineSize, const QString &word);
+    static QSet<size_type> positions(const QVector<Placement> &placements, size_type lineSize);
+    static void solve(Puzzle &puzzle);
+
+    // how many times a word can be found, without collecting where
+    static int count(const QString &contents, size_type lineSize, const QString &word, bool palindrome);
+    static bool isPalindrome(const QString &word);
+
+    static void gridSize(const QString &contents, size_type &lineSize, size_type &rowSize);
+};
+
+#endif // SOLVER_H
@@ -5,6 +5,8 @@
 #include <QString>
 #include <QSet>
 #include <QRect>
+#include <QList>
+#include "wordsearch/puzzle.h"
 
 class QImage;
 
@@ -25,6 +27,10 @@ public:
 
     void find(const QString &word);
 
+    const QList<Puzzle> &puzzles() const { return pagePuzzles; }
+    Puzzle puzzle() const;
+    void showPuzzle(int index);
+
     QSize minimumSizeHint() const override;
 
 signals:
@@ -34,15 +40,15 @@ protected:
     void paintEvent(QPaintEvent *event) override;
 
 private:
-    enum { MagicNumber = 0x7F51C883 };
-
-    bool getText(QString &imageFile);
-    void findWidthHeightSize();
-
     QString wordSearchContents;
     size_type lineSize = 0;
     size_type rowSize = 0;
     QSet<QString::size_type> positions;
+    QVector<Placement> placements;
+
+    // every puzzle in the last image or file opened, the shown one is kept in sync
+    QList<Puzzle> pagePuzzles;
+    int currentPuzzle = -1;
 
     QRect idealSize;
 };